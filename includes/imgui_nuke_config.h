@@ -0,0 +1,70 @@
+#ifndef IMGUI_NUKE_CONFIG_HEADER
+#define IMGUI_NUKE_CONFIG_HEADER
+
+// imgui compile time configuration, included by imgui.h through IMGUI_USER_CONFIG so imgui's own
+// sources and the plugins agree on the vertex and index types. See the CMake options of the same name.
+
+// 32-bit indices, a draw list can then hold more than 64k vertices.
+#ifdef IMGUI_NUKE_32BIT_INDICES
+#define ImDrawIdx unsigned int
+#endif
+
+// 12 byte ImDrawVert instead of 20: positions stored as 16-bit fixed point with 1/IMGUI_NUKE_DRAWVERT_POS_SCALE
+// pixel precision, uvs as 16-bit normalized integers. The members still read and write as floats / ImVec2
+// so imgui's vertex shading keeps working.
+// Positions are quantized in absolute display coordinates, not relative to DisplayPos, and clamped to
+// +-32767/IMGUI_NUKE_DRAWVERT_POS_SCALE pixels, 8191 with the default scale.
+// Uvs have to stay within [-1, 1], so images can't use uvs above 1 to repeat a texture.
+#ifdef IMGUI_NUKE_COMPACT_DRAWVERT
+
+#ifndef IMGUI_NUKE_DRAWVERT_POS_SCALE
+#define IMGUI_NUKE_DRAWVERT_POS_SCALE 4
+#endif
+
+// The metrics window prints vertex positions and uvs through printf style varargs, which can't
+// convert the members back to float.
+#ifndef IMGUI_DISABLE_METRICS_WINDOW
+#define IMGUI_DISABLE_METRICS_WINDOW
+#endif
+
+#define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT \
+    struct ImGuiNukeDrawVertComponent \
+    { \
+        short v; \
+        static short Quantize(float f) \
+        { \
+            f = f < -32767.0f ? -32767.0f : (f > 32767.0f ? 32767.0f : f); \
+            return (short)(f >= 0.0f ? f + 0.5f : f - 0.5f); \
+        } \
+    }; \
+    struct ImGuiNukeDrawVertPosComponent : public ImGuiNukeDrawVertComponent \
+    { \
+        operator float() const { return v * (1.0f / IMGUI_NUKE_DRAWVERT_POS_SCALE); } \
+        void operator=(float f) { v = Quantize(f * IMGUI_NUKE_DRAWVERT_POS_SCALE); } \
+    }; \
+    struct ImGuiNukeDrawVertUvComponent : public ImGuiNukeDrawVertComponent \
+    { \
+        operator float() const { return v * (1.0f / 32767.0f); } \
+        void operator=(float f) \
+        { \
+            IM_ASSERT(f >= -1.0001f && f <= 1.0001f && "uvs outside [-1, 1] aren't supported by IMGUI_NUKE_COMPACT_DRAWVERT"); \
+            v = Quantize(f * 32767.0f); \
+        } \
+    }; \
+    template<class T> \
+    struct ImGuiNukeDrawVertVec2 \
+    { \
+        T x, y; \
+        operator ImVec2() const { return ImVec2(x, y); } \
+        void operator=(const ImVec2& p) { x = p.x; y = p.y; } \
+    }; \
+    struct ImDrawVert \
+    { \
+        ImGuiNukeDrawVertVec2<ImGuiNukeDrawVertPosComponent> pos; \
+        ImGuiNukeDrawVertVec2<ImGuiNukeDrawVertUvComponent>  uv; \
+        ImU32                                                col; \
+    };
+
+#endif
+
+#endif
@@ -0,0 +1,491 @@
+#ifndef IMGUI_NUKE_GLYPH_CACHE_HEADER
+#define IMGUI_NUKE_GLYPH_CACHE_HEADER
+
+#include "imgui.h"
+
+#include "DDImage/gl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// imgui_draw.cpp keeps its copy of stb_truetype static, so the glyph cache needs its own. Define
+// IMGUI_NUKE_GLYPH_CACHE_IMPLEMENTATION in exactly one source file of the plugin before including
+// this header (or imgui_nuke.h) to compile it there, every other file only sees the declarations.
+#ifdef IMGUI_STB_TRUETYPE_FILENAME
+#include IMGUI_STB_TRUETYPE_FILENAME
+#else
+#include "imstb_truetype.h"
+#endif
+
+#if defined(IMGUI_NUKE_GLYPH_CACHE_IMPLEMENTATION) && !defined(IMGUI_NUKE_GLYPH_CACHE_IMPLEMENTED)
+#define IMGUI_NUKE_GLYPH_CACHE_IMPLEMENTED
+// same warnings as imgui_draw.cpp silences for its copy
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4456)
+#endif
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"
+#pragma clang diagnostic ignored "-Wmissing-prototypes"
+#pragma clang diagnostic ignored "-Wimplicit-fallthrough"
+#pragma clang diagnostic ignored "-Wcast-qual"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif
+#define STB_TRUETYPE_IMPLEMENTATION
+#ifdef IMGUI_STB_TRUETYPE_FILENAME
+#include IMGUI_STB_TRUETYPE_FILENAME
+#else
+#include "imstb_truetype.h"
+#endif
+#undef STB_TRUETYPE_IMPLEMENTATION
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+#endif
+
+// Font whose glyphs are only rasterized once they are actually drawn, instead of baking every glyph
+// of the configured ranges into the atlas up front.
+//
+// Every codepoint of the ranges gets an invisible placeholder glyph with the correct advance, its
+// negative uvs encoding which glyph it stands for. After a frame is rendered Update() looks at the vertices
+// drawn with this font: placeholders get rasterized into a free slot of the page and uploaded with
+// glTexSubImage2D, and the slots of the glyphs that were drawn are marked as used for this frame.
+// The page starts small and doubles until max_page_size, after that the least recently used glyphs
+// get evicted. New glyphs show up as blanks for the one frame it takes to rasterize them.
+// The font holds one glyph per entry at the same index for its whole life, rasterizing or evicting
+// a glyph only patches that glyph's quad and uvs.
+class ImGuiNukeGlyphCache
+{
+protected:
+    struct Entry
+    {
+        ImWchar codepoint_;
+        int     glyph_index_;
+        float   advance_x_;
+        int     x0_, y0_, x1_, y1_;   // glyph quad, valid while resident
+        int     slot_;                // -1 when not resident
+        bool    empty_;               // nothing to rasterize, eg. spaces
+        bool    requested_;
+    };
+
+    struct Slot
+    {
+        int          entry_;          // -1 when free
+        unsigned int last_used_;
+    };
+
+    std::vector<unsigned char> font_data_;
+    stbtt_fontinfo             font_info_;
+    float                      scale_, ascent_;
+    ImFontConfig               config_;
+    ImFontAtlas                atlas_;  // only provides TexID and the white pixel to the font, never built
+    ImFont*                    font_;
+
+    std::vector<Entry>         entries_;
+    std::vector<Slot>          slots_;  // page split into a grid of cells, row major
+    std::vector<int>           free_slots_, evictable_slots_, requested_, dirty_slots_;
+    std::vector<unsigned char> pixels_; // alpha only copy of the page, kept to re-upload it when it grows
+    int                        cell_w_, cell_h_, columns_, rows_, max_page_size_;
+    GLuint                     texture_;
+    unsigned int               frame_;
+    bool                       page_dirty_;
+
+    int PageWidth() const { return columns_ * cell_w_; }
+    int PageHeight() const { return rows_ * cell_h_; }
+
+    // slot 0 is kept fully white and used as the font's white pixel for filled shapes
+    void ResetPage(int columns, int rows)
+    {
+        std::vector<Slot> old_slots(slots_);
+        std::vector<unsigned char> old_pixels(pixels_);
+        int old_columns = columns_, old_rows = rows_, old_width = PageWidth();
+
+        columns_ = columns;
+        rows_ = rows;
+        Slot free_slot = { -1, 0 };
+        slots_.assign(columns_ * rows_, free_slot);
+        pixels_.assign(PageWidth() * PageHeight(), 0);
+
+        for (int r = 0; r < old_rows; ++r) {
+            for (int c = 0; c < old_columns; ++c) {
+                int slot = r * columns_ + c;
+                slots_[slot] = old_slots[r * old_columns + c];
+                if (slots_[slot].entry_ >= 0) {
+                    entries_[slots_[slot].entry_].slot_ = slot;
+                }
+            }
+        }
+        for (int y = 0; y < old_rows * cell_h_; ++y) {
+            std::copy(old_pixels.begin() + y * old_width, old_pixels.begin() + (y + 1) * old_width,
+                      pixels_.begin() + y * PageWidth());
+        }
+        if (old_slots.empty()) {
+            for (int y = 0; y < cell_h_; ++y) {
+                std::fill(pixels_.begin() + y * PageWidth(), pixels_.begin() + y * PageWidth() + cell_w_, 255);
+            }
+        }
+
+        free_slots_.clear();
+        for (int slot = (int)slots_.size() - 1; slot > 0; --slot) {
+            if (slots_[slot].entry_ < 0) {
+                free_slots_.push_back(slot);
+            }
+        }
+        evictable_slots_.clear();
+
+        atlas_.TexWidth = PageWidth();
+        atlas_.TexHeight = PageHeight();
+        atlas_.TexUvScale = ImVec2(1.0f / PageWidth(), 1.0f / PageHeight());
+        atlas_.TexUvWhitePixel = ImVec2(cell_w_ * 0.5f / PageWidth(), cell_h_ * 0.5f / PageHeight());
+        page_dirty_ = true;
+
+        // the uvs of every resident glyph scale with the page
+        for (size_t slot = 1; slot < slots_.size(); ++slot) {
+            if (slots_[slot].entry_ >= 0) {
+                UpdateGlyph(slots_[slot].entry_);
+            }
+        }
+    }
+
+    int AllocateSlot()
+    {
+        if (free_slots_.empty() && PageWidth() * 2 <= max_page_size_ && PageHeight() * 2 <= max_page_size_) {
+            ResetPage(columns_ * 2, rows_ * 2);
+        }
+        if (!free_slots_.empty()) {
+            int slot = free_slots_.back();
+            free_slots_.pop_back();
+            return slot;
+        }
+
+        // page is full, evict the least recently used glyph that wasn't drawn this frame
+        if (evictable_slots_.empty()) {
+            for (int slot = (int)slots_.size() - 1; slot > 0; --slot) {
+                if (slots_[slot].last_used_ < frame_) {
+                    evictable_slots_.push_back(slot);
+                }
+            }
+            // most recently used first, so the next victim is at the back
+            std::sort(evictable_slots_.begin(), evictable_slots_.end(), SlotUsedLater(slots_));
+        }
+        while (!evictable_slots_.empty()) {
+            int slot = evictable_slots_.back();
+            evictable_slots_.pop_back();
+            if (slots_[slot].last_used_ >= frame_) {
+                continue;
+            }
+            if (slots_[slot].entry_ >= 0) {
+                entries_[slots_[slot].entry_].slot_ = -1;
+                entries_[slots_[slot].entry_].requested_ = false;
+                UpdateGlyph(slots_[slot].entry_);
+                slots_[slot].entry_ = -1;
+            }
+            return slot;
+        }
+        return -1;
+    }
+
+    struct SlotUsedLater
+    {
+        const std::vector<Slot>& slots_;
+        explicit SlotUsedLater(const std::vector<Slot>& slots) : slots_(slots) {}
+        bool operator()(int a, int b) const { return slots_[a].last_used_ > slots_[b].last_used_; }
+    };
+
+    void Rasterize(int entry)
+    {
+        int slot = AllocateSlot();
+        if (slot < 0) {
+            entries_[entry].requested_ = false; // every glyph is in use this frame, the next Scan() asks again
+            return;
+        }
+        Entry& e = entries_[entry];
+        int x = (slot % columns_) * cell_w_ + 1;
+        int y = (slot / columns_) * cell_h_ + 1;
+        int ix0, iy0, ix1, iy1;
+        stbtt_GetGlyphBitmapBox(&font_info_, e.glyph_index_, scale_, scale_, &ix0, &iy0, &ix1, &iy1);
+        int w = std::min(ix1 - ix0, cell_w_ - 2);
+        int h = std::min(iy1 - iy0, cell_h_ - 2);
+
+        // clear the whole cell as it may still hold an evicted glyph
+        for (int row = y - 1; row < y - 1 + cell_h_; ++row) {
+            std::fill(pixels_.begin() + row * PageWidth() + x - 1, pixels_.begin() + row * PageWidth() + x - 1 + cell_w_, 0);
+        }
+        stbtt_MakeGlyphBitmap(&font_info_, &pixels_[y * PageWidth() + x], w, h, PageWidth(), scale_, scale_, e.glyph_index_);
+
+        e.x0_ = ix0;
+        e.y0_ = (int)ascent_ + iy0;
+        e.x1_ = ix0 + w;
+        e.y1_ = (int)ascent_ + iy0 + h;
+        e.slot_ = slot;
+        e.requested_ = false;
+        slots_[slot].entry_ = entry;
+        slots_[slot].last_used_ = frame_;
+        dirty_slots_.push_back(slot);
+        UpdateGlyph(entry);
+    }
+
+    // Placeholder uvs are multiples of -1/32767 so they survive the 16-bit normalized uvs of the
+    // compact ImDrawVert layout (see imgui_nuke_config.h).
+    static ImVec2 EncodeMarker(int entry)
+    {
+        return ImVec2(-(1 + entry % 32767) / 32767.0f, -(1 + entry / 32767) / 32767.0f);
+    }
+
+    static int DecodeMarker(const ImVec2& uv)
+    {
+        return ((int)(-uv.y * 32767.0f + 0.5f) - 1) * 32767 + (int)(-uv.x * 32767.0f + 0.5f) - 1;
+    }
+
+    // Finds the placeholders that got drawn and marks the slots of the resident glyphs as used.
+    void Scan(ImDrawData* draw_data)
+    {
+        const float page_w = (float)PageWidth(), page_h = (float)PageHeight();
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            int idx_offset = 0;
+            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            {
+                const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+                if (!pcmd->UserCallback && pcmd->TextureId == atlas_.TexID)
+                {
+                    for (int i = idx_offset; i < idx_offset + (int)pcmd->ElemCount; ++i)
+                    {
+                        ImVec2 uv = cmd_list->VtxBuffer[pcmd->VtxOffset + cmd_list->IdxBuffer[i]].uv;
+                        if (uv.x < 0.0f)
+                        {
+                            int entry = DecodeMarker(uv);
+                            if (entry >= 0 && entry < (int)entries_.size() && entries_[entry].slot_ < 0 && !entries_[entry].requested_) {
+                                entries_[entry].requested_ = true;
+                                requested_.push_back(entry);
+                            }
+                        }
+                        else
+                        {
+                            int column = std::min((int)(uv.x * page_w) / cell_w_, columns_ - 1);
+                            int row = std::min((int)(uv.y * page_h) / cell_h_, rows_ - 1);
+                            slots_[row * columns_ + column].last_used_ = frame_;
+                        }
+                    }
+                }
+                idx_offset += pcmd->ElemCount;
+            }
+        }
+    }
+
+    // Points the font's glyph of an entry at its slot, or at its placeholder once evicted.
+    void UpdateGlyph(int entry)
+    {
+        const Entry& e = entries_[entry];
+        ImFontGlyph& glyph = font_->Glyphs[entry];
+        if (e.slot_ >= 0) {
+            const float page_w = (float)PageWidth(), page_h = (float)PageHeight();
+            float x = (float)((e.slot_ % columns_) * cell_w_ + 1);
+            float y = (float)((e.slot_ / columns_) * cell_h_ + 1);
+            glyph.X0 = (float)e.x0_;
+            glyph.Y0 = (float)e.y0_;
+            glyph.X1 = (float)e.x1_;
+            glyph.Y1 = (float)e.y1_;
+            glyph.U0 = x / page_w;
+            glyph.V0 = y / page_h;
+            glyph.U1 = (x + e.x1_ - e.x0_) / page_w;
+            glyph.V1 = (y + e.y1_ - e.y0_) / page_h;
+        } else {
+            // zero sized quad, the negative uv encodes which entry to rasterize
+            ImVec2 marker = EncodeMarker(entry);
+            glyph.X0 = glyph.Y0 = glyph.X1 = glyph.Y1 = 0.0f;
+            glyph.U0 = glyph.U1 = marker.x;
+            glyph.V0 = glyph.V1 = marker.y;
+        }
+    }
+
+    void Upload(int x, int y, int w, int h)
+    {
+        std::vector<ImU32> rgba(w * h);
+        for (int row = 0; row < h; ++row) {
+            for (int column = 0; column < w; ++column) {
+                rgba[row * w + column] = IM_COL32(255, 255, 255, pixels_[(y + row) * PageWidth() + x + column]);
+            }
+        }
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, &rgba[0]);
+    }
+
+    void UploadPage()
+    {
+        glBindTexture(GL_TEXTURE_2D, texture_);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        if (page_dirty_) {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PageWidth(), PageHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            Upload(0, 0, PageWidth(), PageHeight());
+        } else {
+            for (size_t i = 0; i < dirty_slots_.size(); ++i) {
+                Upload((dirty_slots_[i] % columns_) * cell_w_, (dirty_slots_[i] / columns_) * cell_h_, cell_w_, cell_h_);
+            }
+        }
+        dirty_slots_.clear();
+        page_dirty_ = false;
+    }
+
+public:
+
+    ImGuiNukeGlyphCache() : scale_(0), ascent_(0), font_(nullptr), cell_w_(0), cell_h_(0), columns_(0), rows_(0),
+                            max_page_size_(0), texture_(0), frame_(0), page_dirty_(false)
+    {}
+
+    ~ImGuiNukeGlyphCache()
+    {
+        DestroyTexture();
+    }
+
+    // glyph_ranges follows the ImFontAtlas convention, pairs of inclusive ranges terminated by 0
+    bool Load(const char* filename, float size_pixels, const ImWchar* glyph_ranges, int max_page_size)
+    {
+        FILE* file = fopen(filename, "rb");
+        if (!file) {
+            fprintf(stderr, "ERROR: ImGuiNukeGlyphCache: failed to open %s!\n", filename);
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        font_data_.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        size_t read = font_data_.empty() ? 0 : fread(&font_data_[0], 1, font_data_.size(), file);
+        fclose(file);
+        if (read != font_data_.size() || font_data_.empty()
+            || !stbtt_InitFont(&font_info_, &font_data_[0], stbtt_GetFontOffsetForIndex(&font_data_[0], 0))) {
+            fprintf(stderr, "ERROR: ImGuiNukeGlyphCache: failed to load font %s!\n", filename);
+            return false;
+        }
+
+        // same metrics as ImFontAtlas would bake, minus the oversampling
+        scale_ = stbtt_ScaleForPixelHeight(&font_info_, size_pixels);
+        int ascent, descent, line_gap;
+        stbtt_GetFontVMetrics(&font_info_, &ascent, &descent, &line_gap);
+        float font_ascent = floorf(ascent * scale_ + (ascent > 0 ? +1 : -1));
+        float font_descent = floorf(descent * scale_ + (descent > 0 ? +1 : -1));
+        ascent_ = (float)(int)(font_ascent + 0.5f);
+
+        // Every cell fits the largest glyph of the ranges plus a pixel of padding on each side. The
+        // font's own bounding box is not used as a few oversized glyphs of CJK or pan-Unicode fonts
+        // would make every cell several em wide.
+        int max_w = 1, max_h = 1;
+        if (!glyph_ranges) {
+            glyph_ranges = atlas_.GetGlyphRangesDefault();
+        }
+        for (const ImWchar* range = glyph_ranges; range[0] && range[1]; range += 2) {
+            for (int codepoint = range[0]; codepoint <= range[1] && entries_.size() < 0xFFFE; ++codepoint) {
+                int glyph_index = stbtt_FindGlyphIndex(&font_info_, codepoint);
+                if (!glyph_index) {
+                    continue;
+                }
+                int advance, left_side_bearing;
+                stbtt_GetGlyphHMetrics(&font_info_, glyph_index, &advance, &left_side_bearing);
+                Entry e = { (ImWchar)codepoint, glyph_index, advance * scale_, 0, 0, 0, 0, -1,
+                            stbtt_IsGlyphEmpty(&font_info_, glyph_index) != 0, false };
+                entries_.push_back(e);
+                if (!e.empty_) {
+                    int ix0, iy0, ix1, iy1;
+                    stbtt_GetGlyphBitmapBox(&font_info_, glyph_index, scale_, scale_, &ix0, &iy0, &ix1, &iy1);
+                    max_w = std::max(max_w, ix1 - ix0);
+                    max_h = std::max(max_h, iy1 - iy0);
+                }
+            }
+        }
+        cell_w_ = max_w + 2;
+        cell_h_ = max_h + 2;
+        max_page_size_ = std::max(max_page_size, 2 * std::max(cell_w_, cell_h_));
+
+        config_.SizePixels = size_pixels;
+        config_.PixelSnapH = true;
+        font_ = IM_NEW(ImFont);
+        font_->FontSize = size_pixels;
+        font_->Ascent = font_ascent;
+        font_->Descent = font_descent;
+        font_->ContainerAtlas = &atlas_;
+        font_->ConfigData = &config_;
+        font_->ConfigDataCount = 1;
+        atlas_.Fonts.push_back(font_);
+
+        // Glyphs[i] belongs to entries_[i], BuildLookupTable() only appends the tab glyph after them.
+        // Empty glyphs never get rasterized, their zero sized quads point at the white slot 0.
+        for (int i = 0; i < (int)entries_.size(); ++i) {
+            const Entry& e = entries_[i];
+            ImVec2 uv = e.empty_ ? ImVec2(0.0f, 0.0f) : EncodeMarker(i);
+            font_->AddGlyph(e.codepoint_, 0, 0, 0, 0, uv.x, uv.y, uv.x, uv.y, e.advance_x_);
+        }
+        font_->BuildLookupTable();
+
+        // start with a page of 4x4 glyphs
+        ResetPage(4, 4);
+        return true;
+    }
+
+    void CreateTexture()
+    {
+        GLint last_texture;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+        glGenTextures(1, &texture_);
+        glBindTexture(GL_TEXTURE_2D, texture_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        page_dirty_ = true;
+        UploadPage();
+        atlas_.TexID = (ImTextureID)(intptr_t)texture_;
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+    }
+
+    void DestroyTexture()
+    {
+        if (texture_) {
+            glDeleteTextures(1, &texture_);
+            atlas_.TexID = 0;
+            texture_ = 0;
+        }
+    }
+
+    // Call once the frame has been drawn.
+    void Update(ImDrawData* draw_data)
+    {
+        if (!texture_) {
+            return;
+        }
+        ++frame_;
+        evictable_slots_.clear();
+        Scan(draw_data);
+        std::vector<int> requested;
+        requested.swap(requested_);
+        for (size_t i = 0; i < requested.size(); ++i) {
+            Rasterize(requested[i]);
+        }
+        if (page_dirty_ || !dirty_slots_.empty()) {
+            GLint last_texture;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+            UploadPage();
+            glBindTexture(GL_TEXTURE_2D, last_texture);
+        }
+    }
+
+    ImFont* GetFont() { return font_; }
+
+    // number of glyphs currently rasterized into the page
+    int GetResidentGlyphCount() const
+    {
+        return (int)(slots_.size() - free_slots_.size()) - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,683 @@
+#ifndef IMGUI_NUKE_RENDERER_HEADER
+#define IMGUI_NUKE_RENDERER_HEADER
+
+#include "imgui.h"
+
+#include "DDImage/gl.h"
+
+#include <cstdint>
+#include <cstdio>
+
+#ifndef DEBUG
+#define DEBUG 0
+#endif
+
+// Attribute formats matching ImDrawVert, which is the compact layout from imgui_nuke_config.h when
+// IMGUI_NUKE_COMPACT_DRAWVERT is defined. Fixed point positions are scaled back to pixels by the
+// projection matrix so every backend keeps using the same shaders.
+struct ImGuiNukeDrawVertFormat
+{
+#ifdef IMGUI_NUKE_COMPACT_DRAWVERT
+    static GLenum PositionType() { return GL_SHORT; }
+    static GLenum UvType() { return GL_SHORT; }
+    static GLboolean UvNormalized() { return GL_TRUE; }
+    static float PositionScale() { return (float)IMGUI_NUKE_DRAWVERT_POS_SCALE; }
+#else
+    static GLenum PositionType() { return GL_FLOAT; }
+    static GLenum UvType() { return GL_FLOAT; }
+    static GLboolean UvNormalized() { return GL_FALSE; }
+    static float PositionScale() { return 1.0f; }
+#endif
+};
+
+
+// Renders imgui draw data with the OpenGL state handling of a specific GL version. The actual
+// renderers are ImGuiNukeRendererImpl<Backend>, where Backend is one of the policies below,
+// and ImGuiNukeCreateRenderer() picks the best one for the current context.
+class ImGuiNukeRenderer
+{
+protected:
+    // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
+    static bool CheckShader(GLuint handle, const char* desc)
+    {
+        GLint status = 0, log_length = 0;
+        glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
+        glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &log_length);
+        if ((GLboolean)status == GL_FALSE) {
+            fprintf(stderr, "ERROR: CreateDeviceObjects: failed to compile %s!\n", desc);
+        }
+        if (log_length > 0)
+        {
+            ImVector<char> buf;
+            buf.resize((int)(log_length + 1));
+            glGetShaderInfoLog(handle, log_length, NULL, (GLchar*)buf.begin());
+            fprintf(stderr, "%s\n", buf.begin());
+        }
+        return (GLboolean)status == GL_TRUE;
+    }
+
+    // If you get an error please report on GitHub. You may try different GL context version or GLSL version.
+    static bool CheckProgram(GLuint handle, const char* desc)
+    {
+        GLint status = 0, log_length = 0;
+        glGetProgramiv(handle, GL_LINK_STATUS, &status);
+        glGetProgramiv(handle, GL_INFO_LOG_LENGTH, &log_length);
+        if ((GLboolean)status == GL_FALSE) {
+            fprintf(stderr, "ERROR: CreateDeviceObjects: failed to link %s!\n", desc);
+        }
+        if (log_length > 0)
+        {
+            ImVector<char> buf;
+            buf.resize((int)(log_length + 1));
+            glGetProgramInfoLog(handle, log_length, NULL, (GLchar*)buf.begin());
+            fprintf(stderr, "%s\n", buf.begin());
+        }
+        return (GLboolean)status == GL_TRUE;
+    }
+
+    size_t uploaded_bytes_;
+
+public:
+    ImGuiNukeRenderer() : uploaded_bytes_(0)
+    {}
+
+    virtual ~ImGuiNukeRenderer() {}
+
+    // vertex and index bytes streamed to the GPU by the last RenderDrawData
+    size_t GetUploadedBytes() const { return uploaded_bytes_; }
+
+    virtual const char* Name() const = 0;
+    virtual bool CreateDeviceObjects() = 0;
+    virtual void DestroyDeviceObjects() = 0;
+    virtual void RenderDrawData(ImDrawData* draw_data) = 0;
+};
+
+
+// OpenGL 2.1: GLSL 1.20 and no vertex array objects, so the attributes are set up on the host's
+// vertex array state. Their enabled flags, pointers and buffers are backed up and restored.
+struct ImGuiNukeGL2
+{
+    struct AttribState
+    {
+        GLint   location, enabled, size, type, normalized, stride, buffer;
+        GLvoid* pointer;
+    };
+
+    struct State
+    {
+        GLint       element_array_buffer;
+        GLint       polygon_mode[2];
+        AttribState attribs[3];
+    };
+
+    static const char* Name() { return "GL2"; }
+    static const GLchar* GlslVersion() { return "#version 120\n"; }
+
+    static const GLchar* VertexShader()
+    {
+        return "uniform mat4 ProjMtx;\n"
+               "attribute vec2 Position;\n"
+               "attribute vec2 UV;\n"
+               "attribute vec4 Color;\n"
+               "varying vec2 Frag_UV;\n"
+               "varying vec4 Frag_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    Frag_UV = UV;\n"
+               "    Frag_Color = Color;\n"
+               "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+               "}\n";
+    }
+
+    static const GLchar* FragmentShader()
+    {
+        return "uniform sampler2D Texture;\n"
+               "varying vec2 Frag_UV;\n"
+               "varying vec4 Frag_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+               "}\n";
+    }
+
+    static void BackupAttrib(AttribState& attrib, int location)
+    {
+        attrib.location = location;
+        if (location < 0) {
+            return;
+        }
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &attrib.enabled);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attrib.size);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_TYPE, &attrib.type);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &attrib.normalized);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &attrib.stride);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &attrib.buffer);
+        glGetVertexAttribPointerv(location, GL_VERTEX_ATTRIB_ARRAY_POINTER, &attrib.pointer);
+    }
+
+    // leaves GL_ARRAY_BUFFER bound to the attribute's buffer, the caller restores it afterwards
+    static void RestoreAttrib(const AttribState& attrib)
+    {
+        if (attrib.location < 0) {
+            return;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, attrib.buffer);
+        glVertexAttribPointer(attrib.location, attrib.size, (GLenum)attrib.type, (GLboolean)attrib.normalized,
+                              attrib.stride, attrib.pointer);
+        if (attrib.enabled) glEnableVertexAttribArray(attrib.location); else glDisableVertexAttribArray(attrib.location);
+    }
+
+    static void Backup(State& state, int position, int uv, int color)
+    {
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &state.element_array_buffer);
+        glGetIntegerv(GL_POLYGON_MODE, state.polygon_mode);
+        BackupAttrib(state.attribs[0], position);
+        BackupAttrib(state.attribs[1], uv);
+        BackupAttrib(state.attribs[2], color);
+    }
+
+    static void Restore(const State& state)
+    {
+        for (int i = 0; i < 3; ++i) {
+            RestoreAttrib(state.attribs[i]);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, state.element_array_buffer);
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)state.polygon_mode[0]);
+    }
+
+    static void SetupRenderState()
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    }
+
+    static bool ClipOriginLowerLeft(const State&) { return true; }
+
+    static void CreateBuffers(GLuint* vbo, GLuint* elements)
+    {
+        glGenBuffers(1, vbo);
+        glGenBuffers(1, elements);
+    }
+
+    static GLuint CreateVertexArray(GLuint vbo, GLuint elements, int position, int uv, int color)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elements);
+        glEnableVertexAttribArray(position);
+        glEnableVertexAttribArray(uv);
+        glEnableVertexAttribArray(color);
+        glVertexAttribPointer(position, 2, ImGuiNukeDrawVertFormat::PositionType(), GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+        glVertexAttribPointer(uv, 2, ImGuiNukeDrawVertFormat::UvType(), ImGuiNukeDrawVertFormat::UvNormalized(), sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+        glVertexAttribPointer(color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+        return 0;
+    }
+
+    // the attributes go back to the host's setup in Restore()
+    static void DestroyVertexArray(GLuint) {}
+
+    static void Upload(GLuint vbo, GLuint elements, const ImDrawList* cmd_list)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elements);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+    }
+
+    static void BindTexture(GLuint texture)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+};
+
+
+#ifdef GL_VERSION_3_0
+// OpenGL 3.0 - 3.2: GLSL 1.30 and a private vertex array object recreated every frame, so the
+// host's vertex array state is never touched.
+struct ImGuiNukeGL30 : public ImGuiNukeGL2
+{
+    struct State
+    {
+        GLint vertex_array;
+        GLint polygon_mode[2];
+    };
+
+    static const char* Name() { return "GL3.0"; }
+    static const GLchar* GlslVersion() { return "#version 130\n"; }
+
+    static const GLchar* VertexShader()
+    {
+        return "uniform mat4 ProjMtx;\n"
+               "in vec2 Position;\n"
+               "in vec2 UV;\n"
+               "in vec4 Color;\n"
+               "out vec2 Frag_UV;\n"
+               "out vec4 Frag_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    Frag_UV = UV;\n"
+               "    Frag_Color = Color;\n"
+               "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+               "}\n";
+    }
+
+    static const GLchar* FragmentShader()
+    {
+        return "uniform sampler2D Texture;\n"
+               "in vec2 Frag_UV;\n"
+               "in vec4 Frag_Color;\n"
+               "out vec4 Out_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+               "}\n";
+    }
+
+    static void Backup(State& state, int, int, int)
+    {
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &state.vertex_array);
+        glGetIntegerv(GL_POLYGON_MODE, state.polygon_mode);
+    }
+
+    static void Restore(const State& state)
+    {
+        glBindVertexArray(state.vertex_array);
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)state.polygon_mode[0]);
+    }
+
+    static bool ClipOriginLowerLeft(const State&) { return true; }
+
+    // Recreate the VAO every time
+    // (This is to easily allow multiple GL contexts. VAO are not shared among GL contexts, and we don't track creation/deletion of windows so we don't have an obvious key to use to cache them.)
+    static GLuint CreateVertexArray(GLuint vbo, GLuint elements, int position, int uv, int color)
+    {
+        GLuint vao_handle = 0;
+        glGenVertexArrays(1, &vao_handle);
+        glBindVertexArray(vao_handle);
+        ImGuiNukeGL2::CreateVertexArray(vbo, elements, position, uv, color);
+        return vao_handle;
+    }
+
+    static void DestroyVertexArray(GLuint vao_handle)
+    {
+        glDeleteVertexArrays(1, &vao_handle);
+    }
+};
+#endif
+
+
+#ifdef GL_VERSION_3_3
+// OpenGL 3.3 core: GLSL 3.30 with explicit attribute locations, sampler objects reset so the
+// texture's own filtering is used.
+struct ImGuiNukeGL33 : public ImGuiNukeGL30
+{
+    struct State
+    {
+        GLint sampler;
+        GLint vertex_array;
+        GLint polygon_mode[2];
+    };
+
+    static const char* Name() { return "GL3.3"; }
+    static const GLchar* GlslVersion() { return "#version 330 core\n"; }
+
+    static const GLchar* VertexShader()
+    {
+        return "layout (location = 0) in vec2 Position;\n"
+               "layout (location = 1) in vec2 UV;\n"
+               "layout (location = 2) in vec4 Color;\n"
+               "uniform mat4 ProjMtx;\n"
+               "out vec2 Frag_UV;\n"
+               "out vec4 Frag_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    Frag_UV = UV;\n"
+               "    Frag_Color = Color;\n"
+               "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
+               "}\n";
+    }
+
+    static const GLchar* FragmentShader()
+    {
+        return "in vec2 Frag_UV;\n"
+               "in vec4 Frag_Color;\n"
+               "uniform sampler2D Texture;\n"
+               "layout (location = 0) out vec4 Out_Color;\n"
+               "void main()\n"
+               "{\n"
+               "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+               "}\n";
+    }
+
+    static void Backup(State& state, int, int, int)
+    {
+        glGetIntegerv(GL_SAMPLER_BINDING, &state.sampler);
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &state.vertex_array);
+        glGetIntegerv(GL_POLYGON_MODE, state.polygon_mode);
+    }
+
+    static void Restore(const State& state)
+    {
+        glBindSampler(0, state.sampler);
+        glBindVertexArray(state.vertex_array);
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)state.polygon_mode[0]);
+    }
+
+    static void SetupRenderState()
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
+    }
+
+    static bool ClipOriginLowerLeft(const State&) { return true; }
+};
+#endif
+
+
+#ifdef GL_VERSION_4_5
+// OpenGL 4.5: same shaders as 3.3 but buffers, vertex array and textures are edited through direct
+// state access, so streaming the draw lists doesn't need to bind anything, plus glClipControl support.
+// The vertex array is still recreated every frame, like ImGuiNukeGL30 does, as VAOs aren't shared
+// between contexts.
+struct ImGuiNukeGL45 : public ImGuiNukeGL33
+{
+    struct State : public ImGuiNukeGL33::State
+    {
+        GLint clip_origin;
+    };
+
+    static const char* Name() { return "GL4.5"; }
+    static const GLchar* GlslVersion() { return "#version 450 core\n"; }
+
+    static void Backup(State& state, int position, int uv, int color)
+    {
+        ImGuiNukeGL33::Backup(state, position, uv, color);
+        glGetIntegerv(GL_CLIP_ORIGIN, &state.clip_origin); // Support for GL 4.5's glClipControl(GL_UPPER_LEFT)
+    }
+
+    static bool ClipOriginLowerLeft(const State& state) { return state.clip_origin != GL_UPPER_LEFT; }
+
+    static void CreateBuffers(GLuint* vbo, GLuint* elements)
+    {
+        glCreateBuffers(1, vbo);
+        glCreateBuffers(1, elements);
+    }
+
+    static GLuint CreateVertexArray(GLuint vbo, GLuint elements, int position, int uv, int color)
+    {
+        GLuint vao_handle = 0;
+        glCreateVertexArrays(1, &vao_handle);
+        glVertexArrayVertexBuffer(vao_handle, 0, vbo, 0, sizeof(ImDrawVert));
+        glVertexArrayElementBuffer(vao_handle, elements);
+        glEnableVertexArrayAttrib(vao_handle, position);
+        glEnableVertexArrayAttrib(vao_handle, uv);
+        glEnableVertexArrayAttrib(vao_handle, color);
+        glVertexArrayAttribFormat(vao_handle, position, 2, ImGuiNukeDrawVertFormat::PositionType(), GL_FALSE, IM_OFFSETOF(ImDrawVert, pos));
+        glVertexArrayAttribFormat(vao_handle, uv, 2, ImGuiNukeDrawVertFormat::UvType(), ImGuiNukeDrawVertFormat::UvNormalized(), IM_OFFSETOF(ImDrawVert, uv));
+        glVertexArrayAttribFormat(vao_handle, color, 4, GL_UNSIGNED_BYTE, GL_TRUE, IM_OFFSETOF(ImDrawVert, col));
+        glVertexArrayAttribBinding(vao_handle, position, 0);
+        glVertexArrayAttribBinding(vao_handle, uv, 0);
+        glVertexArrayAttribBinding(vao_handle, color, 0);
+        glBindVertexArray(vao_handle);
+        return vao_handle;
+    }
+
+    static void Upload(GLuint vbo, GLuint elements, const ImDrawList* cmd_list)
+    {
+        glNamedBufferData(vbo, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        glNamedBufferData(elements, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+    }
+
+    static void BindTexture(GLuint texture)
+    {
+        glBindTextureUnit(0, texture);
+    }
+};
+#endif
+
+
+template<class Backend>
+class ImGuiNukeRendererImpl : public ImGuiNukeRenderer
+{
+protected:
+    // OpenGL Data
+    GLuint       shader_handle_, vert_handle_, frag_handle_;
+    int          attrib_location_tex_, attrib_location_proj_matrix_;
+    int          attrib_location_position_, attrib_location_uv_, attrib_location_color_;
+    GLuint       vbo_handle_, elements_handle_;
+
+    // The clip origin is resolved once per frame, so the loop itself only branches on what imgui asks for.
+    template<bool ClipOriginLowerLeft>
+    void RenderCommands(ImDrawData* draw_data, int fb_width, int fb_height)
+    {
+        const GLenum index_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+        // Will project scissor/clipping rectangles into framebuffer space
+        ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+        ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+        // Render command lists
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            size_t idx_buffer_offset = 0;
+
+            Backend::Upload(vbo_handle_, elements_handle_, cmd_list);
+            uploaded_bytes_ += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert) + cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+
+            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            {
+                const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+                if (pcmd->UserCallback)
+                {
+                    // User callback (registered via ImDrawList::AddCallback)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                }
+                else
+                {
+                    // Project scissor/clipping rectangles into framebuffer space
+                    ImVec4 clip_rect;
+                    clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
+                    clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
+                    clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
+                    clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+
+                    if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
+                    {
+                        // Apply scissor/clipping rectangle
+                        if (ClipOriginLowerLeft) {
+                            glScissor((int) clip_rect.x, (int) (fb_height - clip_rect.w), (int) (clip_rect.z - clip_rect.x),
+                                      (int) (clip_rect.w - clip_rect.y));
+                        } else {
+                            glScissor((int) clip_rect.x, (int) clip_rect.y, (int) clip_rect.z, (int) clip_rect.w); // Support for GL 4.5's glClipControl(GL_UPPER_LEFT)
+                        }
+
+                        // Bind texture, Draw
+                        Backend::BindTexture((GLuint)(intptr_t)pcmd->TextureId);
+                        glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, index_type, (void*)idx_buffer_offset);
+                    }
+                }
+                idx_buffer_offset += pcmd->ElemCount * sizeof(ImDrawIdx);
+            }
+        }
+    }
+
+public:
+
+    ImGuiNukeRendererImpl() : shader_handle_(0), vert_handle_(0), frag_handle_(0),
+                              attrib_location_tex_(0), attrib_location_proj_matrix_(0), attrib_location_position_(0),
+                              attrib_location_uv_(0), attrib_location_color_(0), vbo_handle_(0), elements_handle_(0)
+    {}
+
+    const char* Name() const { return Backend::Name(); }
+
+    bool CreateDeviceObjects()
+    {
+        // Create shaders
+        const GLchar* vertex_shader_with_version[2] = { Backend::GlslVersion(), Backend::VertexShader() };
+        vert_handle_ = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vert_handle_, 2, vertex_shader_with_version, NULL);
+        glCompileShader(vert_handle_);
+        CheckShader(vert_handle_, "vertex shader");
+
+        const GLchar* fragment_shader_with_version[2] = { Backend::GlslVersion(), Backend::FragmentShader() };
+        frag_handle_ = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(frag_handle_, 2, fragment_shader_with_version, NULL);
+        glCompileShader(frag_handle_);
+        CheckShader(frag_handle_, "fragment shader");
+
+        shader_handle_ = glCreateProgram();
+        glAttachShader(shader_handle_, vert_handle_);
+        glAttachShader(shader_handle_, frag_handle_);
+        glLinkProgram(shader_handle_);
+        bool linked = CheckProgram(shader_handle_, "shader program");
+
+        attrib_location_tex_ = glGetUniformLocation(shader_handle_, "Texture");
+        attrib_location_proj_matrix_ = glGetUniformLocation(shader_handle_, "ProjMtx");
+        attrib_location_position_ = glGetAttribLocation(shader_handle_, "Position");
+        attrib_location_uv_ = glGetAttribLocation(shader_handle_, "UV");
+        attrib_location_color_ = glGetAttribLocation(shader_handle_, "Color");
+
+        // Create buffers
+        Backend::CreateBuffers(&vbo_handle_, &elements_handle_);
+
+        return linked;
+    }
+
+    void DestroyDeviceObjects()
+    {
+        if (vbo_handle_) glDeleteBuffers(1, &vbo_handle_);
+        if (elements_handle_) glDeleteBuffers(1, &elements_handle_);
+        vbo_handle_ = elements_handle_ = 0;
+
+        if (shader_handle_ && vert_handle_) glDetachShader(shader_handle_, vert_handle_);
+        if (vert_handle_) glDeleteShader(vert_handle_);
+        vert_handle_ = 0;
+
+        if (shader_handle_ && frag_handle_) glDetachShader(shader_handle_, frag_handle_);
+        if (frag_handle_) glDeleteShader(frag_handle_);
+        frag_handle_ = 0;
+
+        if (shader_handle_) glDeleteProgram(shader_handle_);
+        shader_handle_ = 0;
+    }
+
+    // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to run within any OpenGL engine that doesn't do so.
+    void RenderDrawData(ImDrawData* draw_data)
+    {
+        // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+        int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+        int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+        if (fb_width <= 0 || fb_height <= 0)
+            return;
+
+        // Backup GL state
+        GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+        glActiveTexture(GL_TEXTURE0);
+        GLint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+        GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+        GLint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+        GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
+        GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+        GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
+        GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
+        GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
+        GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
+        GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
+        GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
+        GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
+        GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+        GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+        GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+        typename Backend::State last_backend_state;
+        Backend::Backup(last_backend_state, attrib_location_position_, attrib_location_uv_, attrib_location_color_);
+
+        // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_SCISSOR_TEST);
+        Backend::SetupRenderState();
+
+        // Setup viewport, orthographic projection matrix
+        // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayMin is typically (0,0) for single viewport apps.
+        glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+        float L = draw_data->DisplayPos.x;
+        float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
+        float T = draw_data->DisplayPos.y;
+        float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
+        float S = ImGuiNukeDrawVertFormat::PositionScale();
+        const float ortho_projection[4][4] =
+                {
+                        { 2.0f/(R-L)/S, 0.0f,         0.0f,   0.0f },
+                        { 0.0f,         2.0f/(T-B)/S, 0.0f,   0.0f },
+                        { 0.0f,         0.0f,        -1.0f,   0.0f },
+                        { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
+                };
+        glUseProgram(shader_handle_);
+        glUniform1i(attrib_location_tex_, 0);
+        glUniformMatrix4fv(attrib_location_proj_matrix_, 1, GL_FALSE, &ortho_projection[0][0]);
+
+        uploaded_bytes_ = 0;
+        GLuint vao_handle = Backend::CreateVertexArray(vbo_handle_, elements_handle_, attrib_location_position_,
+                                                       attrib_location_uv_, attrib_location_color_);
+        if (Backend::ClipOriginLowerLeft(last_backend_state)) {
+            RenderCommands<true>(draw_data, fb_width, fb_height);
+        } else {
+            RenderCommands<false>(draw_data, fb_width, fb_height);
+        }
+        Backend::DestroyVertexArray(vao_handle);
+
+        // Restore modified GL state
+        glUseProgram(last_program);
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+        glActiveTexture(last_active_texture);
+        Backend::Restore(last_backend_state);
+        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+        glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
+        glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
+        if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+        glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+        glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    }
+};
+
+
+// Picks the most specialized renderer the current GL context and the GL headers support.
+inline ImGuiNukeRenderer* ImGuiNukeCreateRenderer()
+{
+    int major = 0, minor = 0;
+    const char* gl_version_string = (const char*)glGetString(GL_VERSION);
+    if (gl_version_string) {
+        sscanf(gl_version_string, "%d.%d", &major, &minor);
+    }
+    int gl_version = major * 100 + minor * 10;
+    ImGuiNukeRenderer* renderer = NULL;
+#ifdef GL_VERSION_4_5
+    if (!renderer && gl_version >= 450) {
+        renderer = new ImGuiNukeRendererImpl<ImGuiNukeGL45>();
+    }
+#endif
+#ifdef GL_VERSION_3_3
+    if (!renderer && gl_version >= 330) {
+        renderer = new ImGuiNukeRendererImpl<ImGuiNukeGL33>();
+    }
+#endif
+#ifdef GL_VERSION_3_0
+    if (!renderer && gl_version >= 300) {
+        renderer = new ImGuiNukeRendererImpl<ImGuiNukeGL30>();
+    }
+#endif
+    if (!renderer) {
+        renderer = new ImGuiNukeRendererImpl<ImGuiNukeGL2>();
+    }
+    if (DEBUG) {
+        fprintf(stderr, "ImGuiNukeCreateRenderer: %s renderer for OpenGL %s\n", renderer->Name(), gl_version_string);
+    }
+    return renderer;
+}
+
+#endif
@@ -0,0 +1,736 @@
+#ifndef IMGUI_NUKE_TABLE_HEADER
+#define IMGUI_NUKE_TABLE_HEADER
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum ImGuiNukeColumnType
+{
+    ImGuiNukeColumnType_String,
+    ImGuiNukeColumnType_Number
+};
+
+// Read only access to the rows displayed by ImGuiNukeTableView and ImGuiNukeTreeView.
+// Version() has to change whenever anything changes, RowVersion() is the Version() at which
+// a row was last added or modified so the views can re-sort and re-filter only those rows.
+// Bumping LayoutVersion() (rows removed, columns added, ...) forces a full rebuild.
+// Sources that can list their changed rows should implement ChangedRows(), otherwise the
+// views find them by checking RowVersion() of every row whenever Version() changes.
+class ImGuiNukeDataSource
+{
+public:
+    virtual ~ImGuiNukeDataSource() {}
+
+    virtual int RowCount() const = 0;
+    virtual int ColumnCount() const = 0;
+    virtual const char* ColumnName(int column) const = 0;
+    virtual ImGuiNukeColumnType ColumnType(int column) const = 0;
+
+    // only called for the matching column type
+    virtual const char* GetString(int column, int row) const = 0;
+    virtual double GetNumber(int column, int row) const = 0;
+
+    // parent row used by the tree view, -1 for a root row
+    virtual int ParentRow(int row) const { return -1; }
+
+    virtual unsigned int Version() const = 0;
+    virtual unsigned int LayoutVersion() const = 0;
+    virtual unsigned int RowVersion(int row) const = 0;
+
+    // Appends the rows added or modified after since_version to rows (duplicates allowed),
+    // returns false when the source can't tell and every row has to be checked instead.
+    virtual bool ChangedRows(unsigned int since_version, std::vector<int>& rows) const { return false; }
+};
+
+
+// Default data source keeping every column in its own contiguous array (structure of arrays),
+// so sorting and filtering on a column only ever touch that column's memory.
+class ImGuiNukeColumnarData : public ImGuiNukeDataSource
+{
+protected:
+    struct Column
+    {
+        std::string              name_;
+        ImGuiNukeColumnType      type_;
+        std::vector<std::string> strings_;
+        std::vector<double>      numbers_;
+    };
+
+    std::vector<Column>       columns_;
+    std::vector<int>          parents_;
+    std::vector<unsigned int> row_versions_;
+    int                       row_count_;
+    unsigned int              version_, layout_version_;
+
+    // (version, row) of the latest changes, complete for every version after change_log_start_
+    std::vector<std::pair<unsigned int, int> > change_log_;
+    unsigned int                                change_log_start_;
+
+    void Touch(int row)
+    {
+        row_versions_[row] = ++version_;
+        // once the log outgrows the rows a full scan is as cheap, drop the older half
+        if (change_log_.size() >= 1024 && change_log_.size() >= (size_t)row_count_) {
+            size_t dropped = change_log_.size() / 2;
+            change_log_start_ = change_log_[dropped - 1].first;
+            change_log_.erase(change_log_.begin(), change_log_.begin() + dropped);
+        }
+        change_log_.push_back(std::make_pair(version_, row));
+    }
+
+    void ResizeColumn(Column& column)
+    {
+        if (column.type_ == ImGuiNukeColumnType_String) {
+            column.strings_.resize(row_count_);
+        } else {
+            column.numbers_.resize(row_count_, 0.0);
+        }
+    }
+
+public:
+
+    ImGuiNukeColumnarData() : row_count_(0), version_(1), layout_version_(1), change_log_start_(1)
+    {}
+
+    int AddColumn(const char* name, ImGuiNukeColumnType type)
+    {
+        Column column;
+        column.name_ = name;
+        column.type_ = type;
+        ResizeColumn(column);
+        columns_.push_back(column);
+        ++version_;
+        ++layout_version_;
+        return (int)columns_.size() - 1;
+    }
+
+    // Appending rows keeps the cached sort order and filter results of the views valid,
+    // only the new rows get merged in.
+    int AddRow(int parent = -1)
+    {
+        int row = row_count_++;
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            ResizeColumn(columns_[c]);
+        }
+        parents_.push_back(parent);
+        row_versions_.push_back(0);
+        Touch(row);
+        return row;
+    }
+
+    void Reserve(int rows)
+    {
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            if (columns_[c].type_ == ImGuiNukeColumnType_String) {
+                columns_[c].strings_.reserve(rows);
+            } else {
+                columns_[c].numbers_.reserve(rows);
+            }
+        }
+        parents_.reserve(rows);
+        row_versions_.reserve(rows);
+    }
+
+    void Clear()
+    {
+        row_count_ = 0;
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            columns_[c].strings_.clear();
+            columns_[c].numbers_.clear();
+        }
+        parents_.clear();
+        row_versions_.clear();
+        ++version_;
+        ++layout_version_;
+        change_log_.clear();
+        change_log_start_ = version_;
+    }
+
+    void SetString(int column, int row, const char* value)
+    {
+        IM_ASSERT(columns_[column].type_ == ImGuiNukeColumnType_String);
+        std::string& cell = columns_[column].strings_[row];
+        if (cell != value) {
+            cell = value;
+            Touch(row);
+        }
+    }
+
+    void SetNumber(int column, int row, double value)
+    {
+        IM_ASSERT(columns_[column].type_ == ImGuiNukeColumnType_Number);
+        double& cell = columns_[column].numbers_[row];
+        if (cell != value) {
+            cell = value;
+            Touch(row);
+        }
+    }
+
+    void SetParent(int row, int parent)
+    {
+        if (parents_[row] != parent) {
+            parents_[row] = parent;
+            Touch(row);
+        }
+    }
+
+    int RowCount() const { return row_count_; }
+    int ColumnCount() const { return (int)columns_.size(); }
+    const char* ColumnName(int column) const { return columns_[column].name_.c_str(); }
+    ImGuiNukeColumnType ColumnType(int column) const { return columns_[column].type_; }
+    const char* GetString(int column, int row) const { return columns_[column].strings_[row].c_str(); }
+    double GetNumber(int column, int row) const { return columns_[column].numbers_[row]; }
+    int ParentRow(int row) const { return parents_[row]; }
+    unsigned int Version() const { return version_; }
+    unsigned int LayoutVersion() const { return layout_version_; }
+    unsigned int RowVersion(int row) const { return row_versions_[row]; }
+
+    bool ChangedRows(unsigned int since_version, std::vector<int>& rows) const
+    {
+        if (since_version < change_log_start_) {
+            return false;
+        }
+        std::vector<std::pair<unsigned int, int> >::const_iterator it = std::upper_bound(
+            change_log_.begin(), change_log_.end(), std::make_pair(since_version, INT_MAX));
+        for (; it != change_log_.end(); ++it) {
+            rows.push_back(it->second);
+        }
+        return true;
+    }
+};
+
+
+// Flat list view over a data source. The sort permutation, the per row filter results and the
+// resulting list of displayed rows are cached and only recomputed for the rows that changed
+// since the last frame, so once the data settles a frame costs the same for 100 or 100k rows:
+// only the rows inside the scroll region are submitted to imgui. A modified row that keeps its
+// place in the sort order is patched into the displayed rows without walking the others.
+class ImGuiNukeTableView
+{
+protected:
+    struct RowCompare
+    {
+        const ImGuiNukeDataSource* data_;
+        int                        column_;
+        bool                       descending_;
+
+        bool operator()(int a, int b) const
+        {
+            int order;
+            if (data_->ColumnType(column_) == ImGuiNukeColumnType_String) {
+                order = strcmp(data_->GetString(column_, a), data_->GetString(column_, b));
+            } else {
+                double va = data_->GetNumber(column_, a), vb = data_->GetNumber(column_, b);
+                order = va < vb ? -1 : (vb < va ? 1 : 0);
+            }
+            if (order == 0) {
+                return a < b; // keep equal keys in row order so the permutation is deterministic
+            }
+            return descending_ ? order > 0 : order < 0;
+        }
+    };
+
+    // orders rows by their place in order_
+    struct PositionCompare
+    {
+        const std::vector<int>* positions_;
+
+        bool operator()(int a, int b) const { return (*positions_)[a] < (*positions_)[b]; }
+    };
+
+    ImGuiTextFilter  filter_;
+    int              filter_column_;
+    int              sort_column_;
+    bool             sort_descending_;
+    int              selected_row_;
+
+    std::vector<int>  order_;       // every row, in sort order
+    std::vector<int>  positions_;   // per row, its index in order_
+    std::vector<char> matches_;     // filter result per row
+    std::vector<int>  rows_;        // displayed rows, in display order
+    std::vector<int>  dirty_;       // rows changed since the last update, sorted
+    std::vector<char> old_matches_; // filter result of dirty_ before the update
+
+    unsigned int cached_version_, cached_layout_version_;
+    int          cached_rows_;
+    bool         order_dirty_, filter_dirty_, rows_dirty_;
+
+    bool MatchesFilter(const ImGuiNukeDataSource& data, int row) const
+    {
+        if (!filter_.IsActive()) {
+            return true;
+        }
+        for (int c = 0; c < data.ColumnCount(); ++c) {
+            if ((filter_column_ < 0 || filter_column_ == c) && data.ColumnType(c) == ImGuiNukeColumnType_String
+                && filter_.PassFilter(data.GetString(c, row))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static const char* CellText(const ImGuiNukeDataSource& data, int column, int row, char* buf, size_t buf_size)
+    {
+        if (data.ColumnType(column) == ImGuiNukeColumnType_String) {
+            return data.GetString(column, row);
+        }
+        snprintf(buf, buf_size, "%g", data.GetNumber(column, row));
+        return buf;
+    }
+
+    // true when every dirty row is still ordered against its neighbours in order_
+    bool IsOrderValid(const RowCompare& compare) const
+    {
+        int size = (int)order_.size();
+        for (size_t i = 0; i < dirty_.size(); ++i) {
+            int row = dirty_[i];
+            if (row >= cached_rows_) {
+                return false;
+            }
+            int p = positions_[row];
+            if ((p > 0 && !compare(order_[p - 1], row)) || (p + 1 < size && !compare(row, order_[p + 1]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Update(const ImGuiNukeDataSource& data)
+    {
+        int row_count = data.RowCount();
+        // SetSort() and SetFilterColumn() don't know the data, and a layout change may remove columns
+        if (sort_column_ < -1 || sort_column_ >= data.ColumnCount()) {
+            sort_column_ = -1;
+            order_dirty_ = true;
+        }
+        if (filter_column_ < -1 || filter_column_ >= data.ColumnCount()) {
+            filter_column_ = -1;
+            filter_dirty_ = true;
+        }
+        if (data.LayoutVersion() != cached_layout_version_ || row_count < cached_rows_) {
+            order_dirty_ = filter_dirty_ = true;
+        }
+
+        // collect the rows that were added or modified since the last update
+        dirty_.clear();
+        if (data.Version() != cached_version_ && !(order_dirty_ && filter_dirty_)) {
+            if (!data.ChangedRows(cached_version_, dirty_)) {
+                dirty_.clear();
+                for (int row = 0; row < row_count; ++row) {
+                    if (row >= cached_rows_ || data.RowVersion(row) > cached_version_) {
+                        dirty_.push_back(row);
+                    }
+                }
+            }
+            std::sort(dirty_.begin(), dirty_.end());
+            dirty_.erase(std::unique(dirty_.begin(), dirty_.end()), dirty_.end());
+        }
+
+        RowCompare compare = { &data, sort_column_, sort_descending_ };
+        bool order_changed = order_dirty_;
+        if (order_dirty_) {
+            order_.resize(row_count);
+            for (int row = 0; row < row_count; ++row) {
+                order_[row] = row;
+            }
+            if (sort_column_ >= 0) {
+                std::sort(order_.begin(), order_.end(), compare);
+            }
+        }
+        else if (!dirty_.empty()) {
+            if (sort_column_ < 0) {
+                // unsorted order is the row order, modified rows stay where they are
+                for (int row = cached_rows_; row < row_count; ++row) {
+                    order_.push_back(row);
+                    positions_.push_back(row);
+                }
+            } else if (!IsOrderValid(compare)) {
+                // the untouched rows are still sorted, take the dirty ones out, sort them and merge them back
+                std::vector<char> is_dirty(row_count, 0);
+                for (size_t i = 0; i < dirty_.size(); ++i) {
+                    is_dirty[dirty_[i]] = 1;
+                }
+                size_t kept = 0;
+                for (size_t i = 0; i < order_.size(); ++i) {
+                    if (!is_dirty[order_[i]]) {
+                        order_[kept++] = order_[i];
+                    }
+                }
+                order_.resize(kept);
+                std::vector<int> sorted_dirty(dirty_);
+                std::sort(sorted_dirty.begin(), sorted_dirty.end(), compare);
+                order_.insert(order_.end(), sorted_dirty.begin(), sorted_dirty.end());
+                std::inplace_merge(order_.begin(), order_.begin() + kept, order_.end(), compare);
+                order_changed = true;
+            }
+        }
+        if (order_changed) {
+            positions_.resize(row_count);
+            for (int i = 0; i < row_count; ++i) {
+                positions_[order_[i]] = i;
+            }
+        }
+
+        matches_.resize(row_count, 0);
+        old_matches_.clear();
+        if (filter_dirty_) {
+            for (int row = 0; row < row_count; ++row) {
+                matches_[row] = MatchesFilter(data, row);
+            }
+        } else {
+            for (size_t i = 0; i < dirty_.size(); ++i) {
+                old_matches_.push_back(matches_[dirty_[i]]);
+                matches_[dirty_[i]] = MatchesFilter(data, dirty_[i]);
+            }
+        }
+
+        if (order_changed || filter_dirty_ || rows_dirty_ || !UpdateRows(data)) {
+            BuildRows(data, order_changed || filter_dirty_ || !dirty_.empty());
+        }
+
+        cached_version_ = data.Version();
+        cached_layout_version_ = data.LayoutVersion();
+        cached_rows_ = row_count;
+        order_dirty_ = filter_dirty_ = rows_dirty_ = false;
+    }
+
+    // turns the sort order and filter results into the list of displayed rows,
+    // data_changed is false when only the expansion state of the tree changed
+    virtual void BuildRows(const ImGuiNukeDataSource& data, bool data_changed)
+    {
+        rows_.clear();
+        for (size_t i = 0; i < order_.size(); ++i) {
+            if (matches_[order_[i]]) {
+                rows_.push_back(order_[i]);
+            }
+        }
+    }
+
+    // Patches the displayed rows for the dirty rows when the order didn't change,
+    // returns false when BuildRows() has to be used instead.
+    virtual bool UpdateRows(const ImGuiNukeDataSource& data)
+    {
+        // inserting one by one only pays off for a few rows
+        if (dirty_.size() * 16 > order_.size()) {
+            return false;
+        }
+        PositionCompare compare = { &positions_ };
+        for (size_t i = 0; i < dirty_.size(); ++i) {
+            int row = dirty_[i];
+            if (old_matches_[i] == matches_[row]) {
+                continue;
+            }
+            std::vector<int>::iterator it = std::lower_bound(rows_.begin(), rows_.end(), row, compare);
+            if (matches_[row]) {
+                rows_.insert(it, row);
+            } else {
+                IM_ASSERT(it != rows_.end() && *it == row);
+                rows_.erase(it);
+            }
+        }
+        return true;
+    }
+
+    // draws the first cell of a displayed row, returns true when the row got clicked
+    virtual bool DrawFirstCell(const ImGuiNukeDataSource& data, int index)
+    {
+        char buf[64];
+        int row = rows_[index];
+        return ImGui::Selectable(CellText(data, 0, row, buf, sizeof(buf)), selected_row_ == row,
+                                 ImGuiSelectableFlags_SpanAllColumns);
+    }
+
+public:
+
+    ImGuiNukeTableView() : filter_column_(-1), sort_column_(-1), sort_descending_(false), selected_row_(-1),
+                           cached_version_(0), cached_layout_version_(0), cached_rows_(0),
+                           order_dirty_(true), filter_dirty_(true), rows_dirty_(true)
+    {}
+
+    virtual ~ImGuiNukeTableView() {}
+
+    // Draws the filter, the column headers and the visible rows, returns true when the selection changed.
+    bool Draw(const char* str_id, const ImGuiNukeDataSource& data, const ImVec2& size = ImVec2(0, 0))
+    {
+        int columns = data.ColumnCount();
+        if (columns <= 0) {
+            return false;
+        }
+
+        ImGui::PushID(str_id);
+        if (filter_.Draw("Filter")) {
+            filter_dirty_ = true;
+        }
+        Update(data);
+
+        bool selection_changed = false;
+        ImGui::BeginChild("##rows", size, true);
+        ImGui::Columns(columns, "##columns");
+
+        // clicking a header sorts by that column, clicking it again flips the direction
+        for (int c = 0; c < columns; ++c) {
+            char label[256];
+            snprintf(label, sizeof(label), "%s%s", data.ColumnName(c),
+                     sort_column_ != c ? "" : (sort_descending_ ? " v" : " ^"));
+            if (ImGui::Selectable(label, sort_column_ == c)) {
+                SetSort(c, sort_column_ == c && !sort_descending_);
+            }
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+
+        ImGuiListClipper clipper((int)rows_.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                int row = rows_[i];
+                ImGui::PushID(row);
+                if (DrawFirstCell(data, i) && selected_row_ != row) {
+                    selected_row_ = row;
+                    selection_changed = true;
+                }
+                ImGui::NextColumn();
+                for (int c = 1; c < columns; ++c) {
+                    char buf[64];
+                    ImGui::TextUnformatted(CellText(data, c, row, buf, sizeof(buf)));
+                    ImGui::NextColumn();
+                }
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::Columns(1);
+        ImGui::EndChild();
+        ImGui::PopID();
+        return selection_changed;
+    }
+
+    // column -1 restores the data source's row order, as does a column the data source doesn't have
+    void SetSort(int column, bool descending)
+    {
+        if (column != sort_column_ || descending != sort_descending_) {
+            sort_column_ = column;
+            sort_descending_ = descending;
+            order_dirty_ = true;
+        }
+    }
+
+    // restricts the filter to a single string column, -1 (or a column the data source doesn't have) matches against all of them
+    void SetFilterColumn(int column)
+    {
+        if (column != filter_column_) {
+            filter_column_ = column;
+            filter_dirty_ = true;
+        }
+    }
+
+    int GetSortColumn() const { return sort_column_; }
+    bool IsSortDescending() const { return sort_descending_; }
+    ImGuiTextFilter& GetFilter() { return filter_; }
+    int GetSelectedRow() const { return selected_row_; }
+    void SetSelectedRow(int row) { selected_row_ = row; }
+
+    // the data rows currently displayed, in display order
+    const std::vector<int>& GetDisplayRows() const { return rows_; }
+
+    // call after modifying the filter through GetFilter()
+    void Invalidate() { filter_dirty_ = true; }
+};
+
+
+// Tree view over a data source using ParentRow(). Children are shown in the sort order of the
+// table view and ancestors of filter matches stay visible (and open) while filtering. The sibling
+// lists are only rebuilt when the data, sort or filter changes, expanding or collapsing a node
+// only flattens or removes that node's visible subtree.
+class ImGuiNukeTreeView : public ImGuiNukeTableView
+{
+protected:
+    struct Toggle
+    {
+        int row_, index_;
+    };
+
+    std::vector<int>    depths_;           // depth per displayed row
+    std::vector<char>   expanded_;         // expansion state per row
+    std::vector<char>   descendant_match_; // per row, true if a descendant passes the filter
+    std::vector<int>    first_child_, next_sibling_;
+    int                 first_root_;
+    std::vector<int>    stack_, stack_depths_;
+    std::vector<int>    subtree_rows_, subtree_depths_;
+    std::vector<Toggle> toggles_;          // nodes toggled while drawing, in display order
+
+    bool IsOpen(int row) const
+    {
+        return expanded_[row] || (filter_.IsActive() && descendant_match_[row]);
+    }
+
+    void BuildSiblings(const ImGuiNukeDataSource& data)
+    {
+        int row_count = data.RowCount();
+
+        // sibling lists in sort order, built back to front so each insert is a push to the head
+        first_root_ = -1;
+        first_child_.assign(row_count, -1);
+        next_sibling_.assign(row_count, -1);
+        for (int i = (int)order_.size() - 1; i >= 0; --i) {
+            int row = order_[i];
+            int parent = data.ParentRow(row);
+            if (parent < 0 || parent >= row_count || parent == row) {
+                next_sibling_[row] = first_root_;
+                first_root_ = row;
+            } else {
+                next_sibling_[row] = first_child_[parent];
+                first_child_[parent] = row;
+            }
+        }
+
+        descendant_match_.assign(row_count, 0);
+        if (filter_.IsActive()) {
+            for (int row = 0; row < row_count; ++row) {
+                if (!matches_[row]) {
+                    continue;
+                }
+                // stops at the first ancestor already marked, so every row is visited at most once
+                int parent = data.ParentRow(row);
+                while (parent >= 0 && parent < row_count && !descendant_match_[parent]) {
+                    descendant_match_[parent] = 1;
+                    parent = data.ParentRow(parent);
+                }
+            }
+        }
+    }
+
+    // depth first walk of the open nodes starting at the sibling list first,
+    // depths are kept on a second stack alongside the rows
+    void AppendSubtree(int first, int depth, std::vector<int>& rows, std::vector<int>& depths)
+    {
+        stack_.clear();
+        stack_depths_.clear();
+        for (int row = first; row >= 0; row = next_sibling_[row]) {
+            stack_.push_back(row);
+            stack_depths_.push_back(depth);
+        }
+        std::reverse(stack_.begin(), stack_.end());
+        while (!stack_.empty()) {
+            int row = stack_.back();
+            int row_depth = stack_depths_.back();
+            stack_.pop_back();
+            stack_depths_.pop_back();
+            if (!matches_[row] && !descendant_match_[row]) {
+                continue;
+            }
+            rows.push_back(row);
+            depths.push_back(row_depth);
+            if (!IsOpen(row)) {
+                continue;
+            }
+            size_t first_child = stack_.size();
+            for (int child = first_child_[row]; child >= 0; child = next_sibling_[child]) {
+                stack_.push_back(child);
+                stack_depths_.push_back(row_depth + 1);
+            }
+            std::reverse(stack_.begin() + first_child, stack_.end());
+        }
+    }
+
+    void BuildRows(const ImGuiNukeDataSource& data, bool data_changed)
+    {
+        expanded_.resize(data.RowCount(), 0);
+        if (data_changed || (int)first_child_.size() != data.RowCount()) {
+            BuildSiblings(data);
+        }
+        rows_.clear();
+        depths_.clear();
+        toggles_.clear();
+        AppendSubtree(first_root_, 0, rows_, depths_);
+    }
+
+    bool UpdateRows(const ImGuiNukeDataSource& data)
+    {
+        // changed rows can move between parents or change which ancestors match
+        if (!dirty_.empty()) {
+            return false;
+        }
+        // back to front so the indices of the earlier toggles stay valid
+        for (int t = (int)toggles_.size() - 1; t >= 0; --t) {
+            const Toggle& toggle = toggles_[t];
+            int index = toggle.index_;
+            if (index >= (int)rows_.size() || rows_[index] != toggle.row_) {
+                return false;
+            }
+            int end = index + 1;
+            while (end < (int)rows_.size() && depths_[end] > depths_[index]) {
+                ++end;
+            }
+            if (!IsOpen(toggle.row_)) {
+                rows_.erase(rows_.begin() + index + 1, rows_.begin() + end);
+                depths_.erase(depths_.begin() + index + 1, depths_.begin() + end);
+            } else if (end == index + 1) {
+                subtree_rows_.clear();
+                subtree_depths_.clear();
+                AppendSubtree(first_child_[toggle.row_], depths_[index] + 1, subtree_rows_, subtree_depths_);
+                rows_.insert(rows_.begin() + end, subtree_rows_.begin(), subtree_rows_.end());
+                depths_.insert(depths_.begin() + end, subtree_depths_.begin(), subtree_depths_.end());
+            }
+        }
+        toggles_.clear();
+        return true;
+    }
+
+    bool DrawFirstCell(const ImGuiNukeDataSource& data, int index)
+    {
+        char buf[64];
+        int row = rows_[index];
+        bool open = IsOpen(row);
+
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_OpenOnArrow
+                                   | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+        if (first_child_[row] < 0) {
+            flags |= ImGuiTreeNodeFlags_Leaf;
+        }
+        if (selected_row_ == row) {
+            flags |= ImGuiTreeNodeFlags_Selected;
+        }
+
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + depths_[index] * ImGui::GetStyle().IndentSpacing);
+        ImGui::SetNextItemOpen(open);
+        bool now_open = ImGui::TreeNodeEx((void*)(intptr_t)row, flags, "%s", CellText(data, 0, row, buf, sizeof(buf)));
+        if (now_open != open) {
+            // the displayed rows are patched on the next Draw() so the clipper loop isn't disturbed
+            expanded_[row] = now_open;
+            Toggle toggle = { row, index };
+            toggles_.push_back(toggle);
+        }
+        // with OpenOnArrow a click on the label selects without toggling, a click on the arrow only toggles
+        return ImGui::IsItemClicked() && now_open == open;
+    }
+
+public:
+
+    ImGuiNukeTreeView() : first_root_(-1)
+    {}
+
+    bool IsExpanded(int row) const { return row < (int)expanded_.size() && expanded_[row]; }
+
+    void SetExpanded(int row, bool expanded)
+    {
+        if (row >= (int)expanded_.size()) {
+            expanded_.resize(row + 1, 0);
+        }
+        if (expanded_[row] != (char)expanded) {
+            expanded_[row] = expanded;
+            rows_dirty_ = true;
+        }
+    }
+
+    int GetDisplayDepth(int index) const { return depths_[index]; }
+};
+
+#endif
@@ -9,6 +9,8 @@ static const char* const HELP =
 #include "DDImage/Knob.h"
 
 #include "imgui.h"
+// compiles the dynamic font rasterizer, in one source file per plugin
+#define IMGUI_NUKE_GLYPH_CACHE_IMPLEMENTATION
 #include "imgui_nuke.h"
 
 